@@ -25,6 +25,9 @@
 
 #include "Dimensions.hpp"
 #include "Image.h"
+#include "AssetManager.h"
+#include "SpriteAtlas.h"
+#include "Coverage.h"
 #include "Wave.hpp"
 #include "Hearts.hpp"
 #include "Droplet.hpp"
@@ -35,15 +38,20 @@ using namespace g80;
 namespace chr = std::chrono;
 typedef chr::time_point<chr::system_clock> TimePointSysClock;
 typedef chr::system_clock SysClock;
-typedef std::array<Image, 3> DropletAnimation;
-typedef std::array<Droplet, 100> Droplets;
+constexpr int SZ_DROPLETS = 100;
+typedef std::array<Droplet, SZ_DROPLETS> Droplets;
+typedef std::array<SpriteDraw, SZ_DROPLETS * 2> DropletDraws;
 
 constexpr int FPS = 15;
 constexpr int MSPF = 1000 / FPS;
 constexpr float HEART_RADIUS = 10.0f;
+constexpr int DROPLET_BLANK = 3;
 
-auto set_droplet_animation_images(const Image &screen, DropletAnimation &droplet_animation, Droplets &droplets) -> void;
-auto animate_droplets(Image &screen, const DropletAnimation &droplet_animation, Droplets &droplets) -> void;
+auto set_droplet_animation_images(const Image &screen, SpriteAtlas &droplet_atlas, Droplets &droplets) -> void;
+auto animate_droplets(Image &screen, SpriteAtlas &droplet_atlas, Droplets &droplets, DropletDraws &droplet_draws, const Coverage &coverage) -> void;
+auto apply_asset_reload(Image &screen, const Image &heart, Image &behind_heart1, Image &behind_heart2, Image &wave, Uptr_color &wave_averages, Coverage &coverage, Coverage &droplet_coverage) -> void;
+auto put_greetings(Image &screen, const Image &greetings, const Image &download_at) -> void;
+auto is_valid_asset_set(const Image &screen, const Image &marquee, const Image &heart, const Image &greetings, const Image &download_at) -> bool;
 auto set_starting_wave(Image &wave, Uptr_color &wave_averages) -> void;
 auto animate_wave(Image &wave, Uptr_color &wave_averages) -> void;
 auto cache_sin_cos_table() -> void;
@@ -53,56 +61,75 @@ auto delay_until_mspf(const TimePointSysClock &start) -> void;
 
 auto main(int argc, char **argv) -> int {
     
-    Image screen("./asset/screen.img");
-    Image marquee("./asset/marquee.img");
-    Image heart("./asset/heart.img");
+    AssetManager assets("./asset");
+    Image &screen = assets.get("screen.img");
+    Image &marquee = assets.get("marquee.img");
+    Image &heart = assets.get("heart.img");
     Image greetings(" ~ ~ ~ ~ ~ Happy Heart's Day 2022 ~ ~ ~ ~ ~", 2, 0xff);
     Image download_at("https://github.com/everettvergara/HappyValentines2022", 3, 0xff);
     
     Image wave({screen.area().w(), SZ_WAVE_COLORS}, 0xff);
     Uptr_color wave_averages = std::make_unique<Color[]>(wave.area().size());
     
-    DropletAnimation droplet_animation {
-        Image({1, 5}, 0xff), 
-        Image({1, 5}, 0xff), 
-        Image({1, 5}, 0xff)};
+    SpriteAtlas droplet_atlas({{1, 5}, {1, 5}, {1, 5}, {1, 5}}, 0xff);
     Droplets droplets;
+    DropletDraws droplet_draws;
     
-    screen.put_image(greetings, {static_cast<Dimension>(screen.area().w_mid() - greetings.area().w_mid()), 0});
-    screen.put_image(download_at, {static_cast<Dimension>(screen.area().w_mid() - download_at.area().w_mid()), 1});
+    put_greetings(screen, greetings, download_at);
     Image behind_heart1(heart.area());
     Image behind_heart2(heart.area());
+    Coverage coverage(screen.area());
+    Coverage droplet_coverage(screen.area());
     
     cache_sin_cos_table();
     reset_wave_colors(wave_averages, wave.area().size());
-    set_droplet_animation_images(screen, droplet_animation, droplets);
+    set_droplet_animation_images(screen, droplet_atlas, droplets);
 
     SmootherSinCosTable i(5, 30), j (1, 50);
     do {
         // Start timing ms per frame
         TimePointSysClock start {SysClock::now()};
         
-        // Start of Droplet Animation
-        animate_droplets(screen, droplet_animation, droplets);
-
-        // Start of Wave Animation
-        set_starting_wave(wave, wave_averages);
-        animate_wave(wave, wave_averages);
-        screen.put_image(wave, {0, static_cast<Dimension>(screen.area().h() - wave.area().h() - 1)});
-        
+        // Swap in reloaded assets while the screen holds no heart masks
+        if (assets.sync([&](const AssetLookup &lookup) {
+                return is_valid_asset_set(lookup("screen.img"), lookup("marquee.img"), lookup("heart.img"), greetings, download_at);
+            })) {
+            apply_asset_reload(screen, heart, behind_heart1, behind_heart2, wave, wave_averages, coverage, droplet_coverage);
+            put_greetings(screen, greetings, download_at);
+        }
 
         // Start of Hearts Animation
         // Rotate with smoothing function
         i.next(); j.next();
         Point point_heart1 = set_center_pos(screen, heart, i.get(), -1, -1);
         Point point_heart2 = set_center_pos(screen, heart, j.get(), 1, 1);
+        marquee.rotate_left();
+
+        // Cells the marquee will show through the hearts are culled below
+        coverage.clear();
+        coverage.add_mask(heart, point_heart1, marquee);
+        coverage.add_mask(heart, point_heart2, marquee);
+
+        // Droplets are also hidden under the wave strip drawn after them
+        Point point_wave {0, static_cast<Dimension>(screen.area().h() - wave.area().h() - 1)};
+        droplet_coverage.clear();
+        droplet_coverage.add_mask(heart, point_heart1, marquee);
+        droplet_coverage.add_mask(heart, point_heart2, marquee);
+        droplet_coverage.add_rect({point_wave, wave.area()});
+
+        // Start of Droplet Animation
+        animate_droplets(screen, droplet_atlas, droplets, droplet_draws, droplet_coverage);
+
+        // Start of Wave Animation
+        set_starting_wave(wave, wave_averages);
+        animate_wave(wave, wave_averages);
+        coverage.put_visible(screen, wave, point_wave);
 
         // Process hearts 
         behind_heart1.get_image(screen, point_heart1);
         behind_heart2.get_image(screen, point_heart2);
         screen.and_mask(heart, point_heart1);
         screen.and_mask(heart, point_heart2);
-        marquee.rotate_left();
         screen.or_image(marquee, {0, 0});
 
         // Show Hearts, Wave and Greetings
@@ -118,29 +145,12 @@ auto main(int argc, char **argv) -> int {
     } while(!is_key_pressed());
 }
 
-auto set_droplet_animation_images(const Image &screen, DropletAnimation &droplet_animation, Droplets &droplets) -> void {
+auto set_droplet_animation_images(const Image &screen, SpriteAtlas &droplet_atlas, Droplets &droplets) -> void {
     
-    droplet_animation[0].raw_text()[0] = ' ';
-    droplet_animation[0].raw_text()[1] = ' ';
-    droplet_animation[0].raw_text()[2] = '.';
-    droplet_animation[0].raw_text()[3] = '.';
-    droplet_animation[0].raw_text()[4] = '@';
-
-    droplet_animation[1].raw_text()[0] = ' ';
-    droplet_animation[1].raw_text()[1] = ' ';
-    droplet_animation[1].raw_text()[2] = '.';
-    droplet_animation[1].raw_text()[3] = '.';
-    droplet_animation[1].raw_text()[4] = '@';
-
-    droplet_animation[2].raw_text()[0] = ' ';
-    droplet_animation[2].raw_text()[1] = ' ';
-    droplet_animation[2].raw_text()[2] = ' ';
-    droplet_animation[2].raw_text()[3] = '.';
-    droplet_animation[2].raw_text()[4] = '@';     
-
-    for (auto &droplet_image : droplet_animation)
-        for (int i = 0; i < 5; ++i)
-            droplet_image.raw_color()[i] = 4;
+    droplet_atlas.fill_frame(0, "  ..@", 4);
+    droplet_atlas.fill_frame(1, "  ..@", 4);
+    droplet_atlas.fill_frame(2, "   .@", 4);
+    droplet_atlas.fill_frame(DROPLET_BLANK, "     ", 4);
 
     for (auto &droplet : droplets) {
         droplet.point.x = rand() % screen.area().w();
@@ -150,28 +160,85 @@ auto set_droplet_animation_images(const Image &screen, DropletAnimation &droplet
     }
 }
 
-auto animate_droplets(Image &screen, const DropletAnimation &droplet_animation, Droplets &droplets) -> void {
-    int i = 0;
+auto animate_droplets(Image &screen, SpriteAtlas &droplet_atlas, Droplets &droplets, DropletDraws &droplet_draws, const Coverage &coverage) -> void {
+    const Area &area = droplet_atlas.frame_area(0);
+    const Dimension respawn_y = screen.area().h() - 10;
+    size_t erased = 0, drawn = 0;
     for (auto &droplet : droplets) {
-        droplet.animation_ix = (droplet.animation_ix + droplet.ixn);
-        if (droplet.animation_ix == 3) { droplet.animation_ix = 2; droplet.ixn *= -1; }
-        if (droplet.animation_ix == -1) { droplet.animation_ix = 0; droplet.ixn *= -1; }
         
-        if (++droplet.stepper == droplet.stepper_max) {
-            droplet.stepper = 0;
-            ++droplet.point.y;
-        }
+        // A droplet that stays hidden is left alone until it shows again,
+        // or until the sprite it last drew is no longer hidden either
+        Dimension y = droplet.y_after(++droplet.pending);
+        if (y <= respawn_y && coverage.is_covered({{droplet.point.x, y}, area}) && coverage.is_covered({droplet.drawn, area})) 
+            continue;
+
+        droplet.advance(droplet.pending);
 
-        if (droplet.point.y > (screen.area().h() - 10)) {
+        if (droplet.point.y > respawn_y) {
             droplet.point.x = rand() % screen.area().w();
             droplet.point.y = 2;
             droplet.stepper_max = 1 + rand() % 3;
         }
-        screen.put_image(droplet_animation[droplet.animation_ix], droplet.point);
-        ++i;
+
+        // Erase what was last drawn if the droplet skipped past it while hidden
+        if (droplet.pending > 1 && (droplet.drawn.x != droplet.point.x || droplet.drawn.y != droplet.point.y))
+            droplet_draws[erased++] = {DROPLET_BLANK, droplet.drawn};
+
+        droplet.pending = 0;
+        droplet.drawn = droplet.point;
+        droplet_draws[SZ_DROPLETS + drawn++] = {droplet.animation_ix, droplet.point};
+    }
+
+    // Erases go first so they never wipe a droplet drawn in the same frame
+    droplet_atlas.draw(screen, droplet_draws.data(), erased);
+    droplet_atlas.draw(screen, droplet_draws.data() + SZ_DROPLETS, drawn);
+}
+
+auto apply_asset_reload(Image &screen, const Image &heart, Image &behind_heart1, Image &behind_heart2, Image &wave, Uptr_color &wave_averages, Coverage &coverage, Coverage &droplet_coverage) -> void {
+    if (behind_heart1.area().w() != heart.area().w() || behind_heart1.area().h() != heart.area().h()) {
+        Image resized1(heart.area()), resized2(heart.area());
+        behind_heart1.swap(resized1);
+        behind_heart2.swap(resized2);
+    }
+
+    if (wave.area().w() != screen.area().w()) {
+        Image resized({screen.area().w(), SZ_WAVE_COLORS}, 0xff);
+        wave.swap(resized);
+        wave_averages = std::make_unique<Color[]>(wave.area().size());
+        reset_wave_colors(wave_averages, wave.area().size());
+    }
+
+    if (coverage.area().w() != screen.area().w() || coverage.area().h() != screen.area().h()) {
+        coverage.resize(screen.area());
+        droplet_coverage.resize(screen.area());
     }
 }
 
+// Image blits do not clip, so a reloaded set must keep every blit of a frame
+// inside the screen: the marquee spans it, the hearts fit along their whole
+// orbit, and the greetings and wave strip fit.
+auto is_valid_asset_set(const Image &screen, const Image &marquee, const Image &heart, const Image &greetings, const Image &download_at) -> bool {
+    const Area &area = screen.area();
+    if (marquee.area().w() != area.w() || marquee.area().h() != area.h()) return false;
+    if (area.h() <= SZ_WAVE_COLORS + 1) return false;
+    if (area.w() < greetings.area().w() || area.w() < download_at.area().w()) return false;
+    
+    for (int i = 0; i < SZ_DEG_GRANULARITY; ++i) {
+        for (int dir = -1; dir <= 1; dir += 2) {
+            float x = area.w_mid() - heart.area().w_mid() + HEART_RADIUS * cosine[i] * dir;
+            float y = area.h_mid() - heart.area().h_mid() + HEART_RADIUS * sine[i] * dir;
+            if (x < 0 || y < 0) return false;
+            if (static_cast<int>(x) + heart.area().w() > area.w() || static_cast<int>(y) + heart.area().h() > area.h()) return false;
+        }
+    }
+    return true;
+}
+
+auto put_greetings(Image &screen, const Image &greetings, const Image &download_at) -> void {
+    screen.put_image(greetings, {static_cast<Dimension>(screen.area().w_mid() - greetings.area().w_mid()), 0});
+    screen.put_image(download_at, {static_cast<Dimension>(screen.area().w_mid() - download_at.area().w_mid()), 1});
+}
+
 auto cache_sin_cos_table() -> void {
     float rad = 0.0f;
     for (int i = 0; i < SZ_DEG_GRANULARITY; ++i) {
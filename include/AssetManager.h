@@ -0,0 +1,71 @@
+/*
+ *  Asset Manager Class for hot reloading text graphics
+ *  Copyright (C) 2022 Everett Gaius S. Vergara
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *  
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *	
+ */
+
+#ifndef _ASSET_MANAGER_H_
+#define _ASSET_MANAGER_H_
+
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "Image.h"
+
+namespace g80 {
+
+    typedef std::function<auto (const char *filename) -> const Image &> AssetLookup;
+    typedef std::function<auto (const AssetLookup &lookup) -> bool> AssetValidator;
+
+    // Watches an asset directory (inotify, Linux only) and decodes changed
+    // images on a background thread. Decoded images are only applied to the
+    // live ones in sync(), which the caller runs at a frame boundary.
+    class AssetManager {
+    public:
+        AssetManager(const char *directory);
+        ~AssetManager();
+        AssetManager(const AssetManager &) = delete;
+        auto operator=(const AssetManager &) -> AssetManager & = delete;
+
+        auto get(const char *filename) -> Image &;
+        
+        // Applies every pending reload if validate accepts the images as they
+        // would be after applying them. Otherwise the live images stay as they
+        // are and the pending ones are kept, merged with later reloads (newer
+        // wins per file), and validated again on the next sync().
+        auto sync(const AssetValidator &validate) -> bool;
+
+    private:
+        static auto decode(const std::string &path) -> std::unique_ptr<Image>;
+        auto watch() -> void;
+        auto reload(const std::string &filename) -> void;
+
+        std::string directory_;
+        std::map<std::string, std::unique_ptr<Image>> assets_;
+        std::map<std::string, std::unique_ptr<Image>> pending_;
+        std::mutex mutex_;
+        std::atomic<bool> running_{true};
+        int inotify_fd_{-1};
+        std::thread watcher_;
+    };
+}
+
+#endif 
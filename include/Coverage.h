@@ -0,0 +1,53 @@
+/*
+ *  Coverage Class for culling hidden text graphics cells
+ *  Copyright (C) 2022 Everett Gaius S. Vergara
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *  
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *	
+ */
+
+#ifndef _COVERAGE_H_
+#define _COVERAGE_H_
+
+#include "Dimensions.hpp"
+#include "Image.h"
+
+namespace g80 {
+
+    // Marks the screen cells that will be overwritten before the next show(),
+    // so anything drawn there beforehand can be skipped.
+    class Coverage {
+    public:
+        Coverage(Area area);
+
+        auto area() const -> const Area &;
+        auto resize(Area area) -> void;
+        auto clear() -> void;
+
+        // A cell is covered when and_mask(source, point) followed by
+        // or_image(overlay, {0, 0}) would leave its mask at 0x00.
+        auto add_mask(const Image &source, const Point point, const Image &overlay) -> void;
+        auto add_rect(const Rectangle &rect) -> void;
+        
+        // Cells outside the area count as covered.
+        auto is_covered(const Rectangle &rect) const -> bool;
+        auto put_visible(Image &dest, const Image &source, const Point point) const -> void;
+
+    private:
+        Area area_;
+        Uptr_mask covered_{nullptr};
+    };
+}
+
+#endif 
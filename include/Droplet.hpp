@@ -21,6 +21,8 @@
 #ifndef _DROPLET_HPP_
 #define _DROPLET_HPP_
 
+#include <cstdint>
+
 #include "Dimensions.hpp"
 
 namespace g80 {
@@ -30,6 +32,25 @@ namespace g80 {
         int ixn{1};
         int stepper{0};
         int stepper_max{3};
+        int pending{0};
+        Point drawn{UINT16_MAX, UINT16_MAX};  // off-screen until first drawn
+
+        // Row reached after n more frames, without respawning.
+        auto y_after(int frames) const -> Dimension {
+            return point.y + (stepper + frames) / stepper_max;
+        }
+
+        // Advances n frames at once. The animation ping-pongs through
+        // 0, 1, 2, 2, 1, 0 so (animation_ix, ixn) is a phase of period 6.
+        auto advance(int frames) -> void {
+            int phase = (ixn > 0 ? animation_ix : 5 - animation_ix) + frames;
+            phase %= 6;
+            animation_ix = phase < 3 ? phase : 5 - phase;
+            ixn = phase < 3 ? 1 : -1;
+
+            point.y = y_after(frames);
+            stepper = (stepper + frames) % stepper_max;
+        }
     };
 }
 
@@ -47,6 +47,9 @@ namespace g80 {
         auto raw_color() -> Uptr_color &;
         auto raw_text() -> Uptr_text &;
         auto raw_mask() -> Uptr_mask &;
+        auto raw_color() const -> const Uptr_color &;
+        auto raw_text() const -> const Uptr_text &;
+        auto raw_mask() const -> const Uptr_mask &;
         auto area() const -> const Area &;
 
         auto save(const char *filename) -> void;
@@ -59,6 +62,7 @@ namespace g80 {
         auto or_image(const Image &source, const Point point) -> void;
         auto rotate_left() -> void;
         auto put_image(const Image &source, const Point point) -> void;
+        auto swap(Image &rhs) -> void;
         auto show() -> void;
 
     private:
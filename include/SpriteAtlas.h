@@ -0,0 +1,62 @@
+/*
+ *  Sprite Atlas Class for batched text graphics sprites
+ *  Copyright (C) 2022 Everett Gaius S. Vergara
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *  
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *	
+ */
+
+#ifndef _SPRITE_ATLAS_H_
+#define _SPRITE_ATLAS_H_
+
+#include <initializer_list>
+#include <vector>
+
+#include "Dimensions.hpp"
+#include "Image.h"
+
+namespace g80 {
+
+    struct SpriteDraw {
+        int frame;
+        Point point;
+    };
+
+    // All frames of all sprites are stacked top to bottom in one Image,
+    // each frame starting at column 0 of its own band of rows.
+    class SpriteAtlas {
+    public:
+        SpriteAtlas(std::initializer_list<Area> frames, Mask mask = 0x00);
+
+        auto frame_area(int frame) const -> const Area &;
+
+        auto fill_frame(int frame, const char *text, const Color color) -> void;
+        
+        // Blits draws in one pass ordered by destination row, clipped against
+        // the right and bottom edges of the destination. Draws at the same
+        // point keep their list order, so the later one wins. The ordering
+        // lives in a scratch buffer owned by the atlas, so draw is not const.
+        auto draw(Image &dest, const SpriteDraw *draws, size_t count) -> void;
+
+    private:
+        static auto atlas_area(std::initializer_list<Area> frames) -> Area;
+
+        Image atlas_;
+        std::vector<Area> areas_;
+        std::vector<Dimension> offsets_;
+        std::vector<size_t> order_;
+    };
+}
+
+#endif 
@@ -0,0 +1,125 @@
+#include <set>
+#include <stdexcept>
+#include "AssetManager.h"
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+using namespace g80;
+
+constexpr int WATCH_POLL_MS = 100;
+
+AssetManager::AssetManager(const char *directory) : 
+    directory_(directory) {
+
+#ifdef __linux__
+    inotify_fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotify_fd_ == -1) return;
+    if (inotify_add_watch(inotify_fd_, directory, IN_CLOSE_WRITE | IN_MOVED_TO) == -1) {
+        close(inotify_fd_);
+        inotify_fd_ = -1;
+        return;
+    }
+    watcher_ = std::thread(&AssetManager::watch, this);
+#endif
+}
+
+AssetManager::~AssetManager() {
+    running_ = false;
+    if (watcher_.joinable()) watcher_.join();
+#ifdef __linux__
+    if (inotify_fd_ != -1) close(inotify_fd_);
+#endif
+}
+
+auto AssetManager::get(const char *filename) -> Image & {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto loaded = assets_.find(filename);
+    if (loaded == assets_.end()) 
+        loaded = assets_.emplace(filename, decode(directory_ + "/" + filename)).first;
+    return *loaded->second;
+}
+
+// Area::size() is a Dimension, so an image with more cells than a Dimension
+// holds would get buffers smaller than its rows and columns address.
+auto AssetManager::decode(const std::string &path) -> std::unique_ptr<Image> {
+    auto image = std::make_unique<Image>(path.c_str());
+    const Area &area = image->area();
+    if (area.size() != area.w() * area.h())
+        throw std::length_error(path + ": image too large");
+    return image;
+}
+
+auto AssetManager::sync(const AssetValidator &validate) -> bool {
+    std::map<std::string, std::unique_ptr<Image>> pending;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (pending_.empty()) return false;
+        pending.swap(pending_);
+    }
+
+    auto lookup = [&](const char *filename) -> const Image & {
+        auto reloaded = pending.find(filename);
+        return reloaded != pending.end() ? *reloaded->second : *assets_.at(filename);
+    };
+    if (!validate(lookup)) {
+        
+        // Keep the set for the next sync; anything reloaded meanwhile is newer
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto &[filename, image] : pending) 
+            pending_.emplace(filename, std::move(image));
+        return false;
+    }
+
+    for (auto &[filename, image] : pending) {
+        Image &asset = *assets_.at(filename);
+        if (asset.area().w() == image->area().w() && asset.area().h() == image->area().h())
+            asset.put_image(*image, {0, 0});
+        else 
+            asset.swap(*image);
+    }
+    return true;
+}
+
+auto AssetManager::watch() -> void {
+#ifdef __linux__
+    alignas(inotify_event) char buffer[4096];
+    pollfd pfd {inotify_fd_, POLLIN, 0};
+    while (running_) {
+        if (poll(&pfd, 1, WATCH_POLL_MS) <= 0) continue;
+
+        std::set<std::string> changed;
+        ssize_t length;
+        while ((length = read(inotify_fd_, buffer, sizeof(buffer))) > 0) {
+            for (char *p = buffer; p < buffer + length;) {
+                auto *event = reinterpret_cast<inotify_event *>(p);
+                if (event->len) changed.insert(event->name);
+                p += sizeof(inotify_event) + event->len;
+            }
+        }
+        for (auto &filename : changed) 
+            reload(filename);
+    }
+#endif
+}
+
+auto AssetManager::reload(const std::string &filename) -> void {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (assets_.find(filename) == assets_.end()) return;
+    }
+
+    // A partially written file fails to decode; its final close triggers another reload.
+    std::unique_ptr<Image> image;
+    try {
+        image = decode(directory_ + "/" + filename);
+    } catch (const std::exception &) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_[filename] = std::move(image);
+}
@@ -0,0 +1,77 @@
+#include <algorithm>
+#include "Coverage.h"
+
+using namespace g80;
+
+Coverage::Coverage(Area area) : 
+    area_(area),
+    covered_(std::make_unique<Mask[]>(area_.size())) {
+    
+    clear();
+}
+
+auto Coverage::area() const -> const Area & {
+    return area_;
+}
+
+auto Coverage::resize(Area area) -> void {
+    area_ = area;
+    covered_ = std::make_unique<Mask[]>(area_.size());
+    clear();
+}
+
+auto Coverage::clear() -> void {
+    std::fill_n(covered_.get(), area_.size(), 0x00);
+}
+
+auto Coverage::add_mask(const Image &source, const Point point, const Image &overlay) -> void {
+    const Mask *source_mask = source.raw_mask().get();
+    const Mask *overlay_mask = overlay.raw_mask().get();
+    int cols = std::min<int>(source.area().w(), area_.w() - std::min(point.x, area_.w()));
+    int rows = std::min<int>(source.area().h(), area_.h() - std::min(point.y, area_.h()));
+    for (int r = 0; r < rows; ++r) {
+        int y = point.y + r;
+        int si = r * source.area().w();
+        int ci = y * area_.w() + point.x;
+        for (int c = 0, x = point.x; c < cols; ++c, ++x, ++si, ++ci) {
+            
+            // or_image leaves cells outside the overlay as they are, so they stay visible
+            if (source_mask[si] != 0x00 || x >= overlay.area().w() || y >= overlay.area().h()) continue;
+            if (overlay_mask[y * overlay.area().w() + x] == 0x00)
+                covered_[ci] = 0xff;
+        }
+    }
+}
+
+auto Coverage::add_rect(const Rectangle &rect) -> void {
+    int cols = std::min<int>(rect.area.w(), area_.w() - std::min(rect.point.x, area_.w()));
+    int rows = std::min<int>(rect.area.h(), area_.h() - std::min(rect.point.y, area_.h()));
+    for (int r = 0; r < rows; ++r) 
+        std::fill_n(covered_.get() + (rect.point.y + r) * area_.w() + rect.point.x, cols, 0xff);
+}
+
+auto Coverage::is_covered(const Rectangle &rect) const -> bool {
+    int cols = std::min<int>(rect.area.w(), area_.w() - std::min(rect.point.x, area_.w()));
+    int rows = std::min<int>(rect.area.h(), area_.h() - std::min(rect.point.y, area_.h()));
+    for (int r = 0; r < rows; ++r) {
+        int ci = (rect.point.y + r) * area_.w() + rect.point.x;
+        for (int c = 0; c < cols; ++c, ++ci) 
+            if (covered_[ci] == 0x00) return false;
+    }
+    return true;
+}
+
+auto Coverage::put_visible(Image &dest, const Image &source, const Point point) const -> void {
+    int start { point.y * dest.area().w() + point.x };
+    int add_vertical { dest.area().w() - source.area().w() };
+    for (int i = 0; i < source.area().size();) {
+        int ci = start + i;
+        if (ci >= area_.size() || covered_[ci] == 0x00) {
+            dest.raw_color()[ci] = source.raw_color()[i]; 
+            dest.raw_text()[ci] = source.raw_text()[i];
+            dest.raw_mask()[ci] = source.raw_mask()[i];
+        }
+        if (++i % source.area().w() == 0) 
+            start += add_vertical;
+    }
+}
@@ -1,4 +1,5 @@
 #include <algorithm>
+#include <cstring>
 #include "Image.h"
 
 using namespace g80;
@@ -42,6 +43,18 @@ auto Image::raw_mask() -> Uptr_mask & {
     return mask_; 
 }
 
+auto Image::raw_color() const -> const Uptr_color & { 
+    return color_; 
+}
+
+auto Image::raw_text() const -> const Uptr_text & { 
+    return text_; 
+}
+
+auto Image::raw_mask() const -> const Uptr_mask & { 
+    return mask_; 
+}
+
 auto Image::area() const -> const Area & { 
     return area_; 
 }
@@ -146,9 +159,10 @@ auto Image::rotate_left() -> void {
         mask_[i] = mask_[j];
         text_[i] = text_[j];
     }
-    color_[j] = t_color;
-    mask_[j] = t_mask;
-    text_[j] = t_text;
+    int last = area_.size() - 1;
+    color_[last] = t_color;
+    mask_[last] = t_mask;
+    text_[last] = t_text;
 }
 
 auto Image::put_image(const Image &source, const Point point) -> void {
@@ -165,6 +179,13 @@ auto Image::put_image(const Image &source, const Point point) -> void {
     }
 }
 
+auto Image::swap(Image &rhs) -> void {
+    std::swap(area_, rhs.area_);
+    std::swap(color_, rhs.color_);
+    std::swap(text_, rhs.text_);
+    std::swap(mask_, rhs.mask_);
+}
+
 auto Image::show() -> void {
     static const size_t max_color {8};
     static std::string c[max_color] { "\033[30m", "\033[31m", "\033[32m", "\033[33m", "\033[34m", "\033[35m", "\033[36m", "\033[37m" };
@@ -0,0 +1,81 @@
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include "SpriteAtlas.h"
+
+using namespace g80;
+
+SpriteAtlas::SpriteAtlas(std::initializer_list<Area> frames, Mask mask) : 
+    atlas_(atlas_area(frames), mask),
+    areas_(frames) {
+
+    Dimension row = 0;
+    for (auto &area : areas_) {
+        offsets_.push_back(row * atlas_.area().w());
+        row += area.h();
+    }
+}
+
+auto SpriteAtlas::atlas_area(std::initializer_list<Area> frames) -> Area {
+    Dimension w = 0, h = 0;
+    for (auto &area : frames) {
+        w = std::max(w, area.w());
+        h += area.h();
+    }
+    return {w, h};
+}
+
+auto SpriteAtlas::frame_area(int frame) const -> const Area & {
+    return areas_[frame];
+}
+
+auto SpriteAtlas::fill_frame(int frame, const char *text, const Color color) -> void {
+    const Area &area = areas_[frame];
+    Dimension stride = atlas_.area().w();
+    size_t length = strlen(text);
+    for (int i = 0; i < area.size(); ++i) {
+        int ai = offsets_[frame] + (i / area.w()) * stride + i % area.w();
+        atlas_.raw_color()[ai] = color;
+        atlas_.raw_text()[ai] = text[i % length];
+    }
+}
+
+auto SpriteAtlas::draw(Image &dest, const SpriteDraw *draws, size_t count) -> void {
+    order_.resize(count);
+    for (size_t d = 0; d < count; ++d) {
+        assert(draws[d].frame >= 0 && static_cast<size_t>(draws[d].frame) < areas_.size());
+        order_[d] = d;
+    }
+    std::sort(order_.begin(), order_.end(), [draws](size_t a, size_t b) {
+        const Point &pa = draws[a].point, &pb = draws[b].point;
+        if (pa.y != pb.y) return pa.y < pb.y;
+        if (pa.x != pb.x) return pa.x < pb.x;
+        return a < b;
+    });
+
+    const Dimension dest_w = dest.area().w();
+    const Dimension dest_h = dest.area().h();
+    const Dimension stride = atlas_.area().w();
+    Color *dest_color = dest.raw_color().get();
+    Text *dest_text = dest.raw_text().get();
+    Mask *dest_mask = dest.raw_mask().get();
+    const Color *src_color = atlas_.raw_color().get();
+    const Text *src_text = atlas_.raw_text().get();
+    const Mask *src_mask = atlas_.raw_mask().get();
+
+    for (size_t d : order_) {
+        const SpriteDraw &draw = draws[d];
+        if (draw.point.x >= dest_w || draw.point.y >= dest_h) continue;
+        
+        const Area &area = areas_[draw.frame];
+        int cols = std::min<int>(area.w(), dest_w - draw.point.x);
+        int rows = std::min<int>(area.h(), dest_h - draw.point.y);
+        int si = offsets_[draw.frame];
+        int di = draw.point.y * dest_w + draw.point.x;
+        for (int r = 0; r < rows; ++r, si += stride, di += dest_w) {
+            std::copy_n(src_color + si, cols, dest_color + di);
+            std::copy_n(src_text + si, cols, dest_text + di);
+            std::copy_n(src_mask + si, cols, dest_mask + di);
+        }
+    }
+}